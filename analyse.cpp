@@ -0,0 +1,301 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <cstdlib>
+
+#include "src/GameState.hpp"
+#include "src/GameRules.hpp"
+#include "src/Move.hpp"
+#include "src/Search.hpp"
+#include "src/Notation.hpp"
+
+using namespace std;
+
+// Analyse en lot de positions (post-mortem des parties de tournoi).
+//
+// Entrée : une position par ligne, même syntaxe que la commande "position" du mode moteur :
+//     startpos [moves 1B 4TR ...]
+//     board <r,b,t/...x16> <score_p1> <score_p2> <trait> <moves_count> [moves ...]
+// Les lignes vides et celles commençant par '#' sont ignorées.
+//
+// Sortie : une ligne par position, dans l'ordre de l'entrée :
+//     <n° de ligne> bestmove <coup> score <s> depth <d> nodes <n> time <ms> pv <coups...>
+//
+// Chaque thread possède son propre moteur (AI::SearchContext, table de transposition comprise) :
+// aucun état partagé pendant la recherche. Le fichier est lu au fur et à mesure et les positions
+// sont réparties dans une file par thread ; un thread qui a vidé la sienne vole des positions
+// à la fin de la file d'un autre. Le nombre de positions lues mais pas encore écrites est borné.
+
+struct Task
+{
+    size_t index;      // Rang de la position (ordre de sortie)
+    int line_number;   // Ligne dans le fichier d'entrée
+    string position;   // Texte de la position
+};
+
+// File d'un thread : il prend ses tâches par le début (ordre du fichier), les voleurs par la fin
+struct WorkQueue
+{
+    mutex lock;
+    deque<Task> tasks;
+};
+
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int nb_workers) : queues(nb_workers)
+    {
+        for (auto &q : queues)
+            q = make_unique<WorkQueue>();
+    }
+
+    void push(int worker, Task task)
+    {
+        {
+            lock_guard<mutex> guard(queues[worker]->lock);
+            queues[worker]->tasks.push_back(move(task));
+        }
+        lock_guard<mutex> guard(wait_lock);
+        nb_queued++;
+        work_ready.notify_one();
+    }
+
+    // Plus aucune tâche ne sera ajoutée : les threads en attente s'arrêtent quand tout est pris
+    void close()
+    {
+        lock_guard<mutex> guard(wait_lock);
+        closed = true;
+        work_ready.notify_all();
+    }
+
+    // Tâche suivante pour ce thread : la sienne d'abord, sinon vol chez les autres.
+    // Attend tant que le fichier n'est pas fini ; retourne false quand il n'y a plus rien à faire.
+    bool pop(int worker, Task &task)
+    {
+        {
+            // On réserve une tâche : il en reste forcément une dans une des files
+            unique_lock<mutex> guard(wait_lock);
+            work_ready.wait(guard, [&]() { return nb_queued > 0 || closed; });
+            if (nb_queued == 0)
+                return false;
+            nb_queued--;
+        }
+        while (true)
+        {
+            {
+                WorkQueue &own = *queues[worker];
+                lock_guard<mutex> guard(own.lock);
+                if (!own.tasks.empty())
+                {
+                    task = move(own.tasks.front());
+                    own.tasks.pop_front();
+                    return true;
+                }
+            }
+            for (size_t k = 1; k < queues.size(); ++k)
+            {
+                WorkQueue &victim = *queues[(worker + k) % queues.size()];
+                lock_guard<mutex> guard(victim.lock);
+                if (!victim.tasks.empty())
+                {
+                    task = move(victim.tasks.back());
+                    victim.tasks.pop_back();
+                    return true;
+                }
+            }
+        }
+    }
+
+private:
+    vector<unique_ptr<WorkQueue>> queues;
+    mutex wait_lock;
+    condition_variable work_ready;
+    size_t nb_queued = 0; // Tâches en file non réservées
+    bool closed = false;
+};
+
+// Analyse une position avec le moteur du thread et formate la ligne de résultat
+string analyse_position(AI::SearchContext &ctx, const Task &task, const AI::SearchLimits &limits)
+{
+    string prefix = to_string(task.line_number) + " ";
+
+    GameState state;
+    int side_to_move = 1;
+    istringstream position(task.position);
+    if (!Notation::parse_position(position, state, side_to_move))
+        return prefix + "error invalid position";
+    if (GameRules::is_game_over(state))
+        return prefix + "error game over";
+
+    // Tables vidées pour que le résultat ne dépende pas de l'ordre de traitement
+    AI::clear_tables(ctx);
+    Move best = AI::find_best_move(ctx, state, side_to_move, limits);
+    if (best.hole >= NB_HOLES)
+        return prefix + "bestmove none";
+
+    const AI::SearchInfo &info = ctx.info;
+    return prefix + "bestmove " + Notation::move_to_string(best) + " score " + to_string(info.score) +
+           " depth " + to_string(info.depth) + " nodes " + to_string(ctx.nodes_count) +
+           " time " + to_string(static_cast<uint64_t>(info.time_ms)) + " pv " + Notation::pv_to_string(info.pv);
+}
+
+void print_usage()
+{
+    cerr << "Usage : analyse <positions.txt> [-o sortie.txt] [--depth N] [--nodes N] [--movetime MS] [--threads N]" << endl;
+    cerr << "Par défaut : --depth 12, un thread par cœur." << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    ios_base::sync_with_stdio(false);
+
+    string input_path;
+    string output_path;
+    AI::SearchLimits limits;
+    limits.max_depth = 12;
+    int nb_threads = static_cast<int>(thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value)
+            output_path = argv[++i];
+        else if (arg == "--depth" && has_value)
+            limits.max_depth = atoi(argv[++i]);
+        else if (arg == "--nodes" && has_value)
+            limits.max_nodes = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--movetime" && has_value)
+            limits.time_limit_ms = atof(argv[++i]);
+        else if (arg == "--threads" && has_value)
+            nb_threads = atoi(argv[++i]);
+        else if (input_path.empty() && arg[0] != '-')
+            input_path = arg;
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+    if (input_path.empty())
+    {
+        print_usage();
+        return 1;
+    }
+    nb_threads = max(nb_threads, 1);
+
+    ifstream input(input_path);
+    if (!input)
+    {
+        cerr << "Impossible d'ouvrir " << input_path << endl;
+        return 1;
+    }
+
+    ofstream output_file;
+    if (!output_path.empty())
+    {
+        output_file.open(output_path);
+        if (!output_file)
+        {
+            cerr << "Impossible d'écrire " << output_path << endl;
+            return 1;
+        }
+    }
+    ostream &output = output_path.empty() ? cout : output_file;
+
+    // Résultats pas encore écrits : pending[k] est celui de la position de rang nb_written + k
+    struct PendingResult
+    {
+        bool done = false;
+        string text;
+    };
+    const size_t max_pending = 4 * static_cast<size_t>(nb_threads); // Positions lues d'avance, au plus
+    deque<PendingResult> pending;
+    size_t nb_written = 0;
+    mutex results_lock;
+    condition_variable result_ready;
+
+    WorkStealingPool pool(nb_threads);
+    vector<thread> workers;
+    for (int w = 0; w < nb_threads; ++w)
+    {
+        workers.emplace_back([&, w]()
+                             {
+                                 auto ctx = make_unique<AI::SearchContext>(); // Moteur propre au thread
+                                 Task task;
+                                 while (pool.pop(w, task))
+                                 {
+                                     string result = analyse_position(*ctx, task, limits);
+                                     lock_guard<mutex> guard(results_lock);
+                                     PendingResult &slot = pending[task.index - nb_written];
+                                     slot.text = move(result);
+                                     slot.done = true;
+                                     result_ready.notify_one();
+                                 }
+                             });
+    }
+
+    // Écrit, dans l'ordre de l'entrée, les résultats terminés en tête de file
+    auto write_ready = [&](unique_lock<mutex> &guard)
+    {
+        while (!pending.empty() && pending.front().done)
+        {
+            string text = move(pending.front().text);
+            pending.pop_front();
+            nb_written++;
+            guard.unlock();
+            output << text << '\n';
+            output.flush();
+            guard.lock();
+        }
+    };
+
+    // Lecture au fil de l'eau : on attend que des résultats soient écrits avant de lire plus loin
+    string line;
+    size_t nb_tasks = 0;
+    for (int line_number = 1; getline(input, line); ++line_number)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#')
+            continue;
+
+        {
+            unique_lock<mutex> guard(results_lock);
+            write_ready(guard);
+            while (pending.size() >= max_pending)
+            {
+                result_ready.wait(guard, [&]() { return pending.front().done; });
+                write_ready(guard);
+            }
+            pending.emplace_back();
+        }
+        pool.push(static_cast<int>(nb_tasks % nb_threads), {nb_tasks, line_number, line.substr(first)});
+        nb_tasks++;
+    }
+    pool.close();
+
+    // Fin du fichier : on écrit les derniers résultats
+    {
+        unique_lock<mutex> guard(results_lock);
+        while (!pending.empty())
+        {
+            result_ready.wait(guard, [&]() { return pending.front().done; });
+            write_ready(guard);
+        }
+    }
+
+    for (thread &worker : workers)
+        worker.join();
+
+    return 0;
+}
@@ -3,86 +3,56 @@
 #include <vector>
 #include <limits>
 #include <sstream>
+#include <cstdlib>
 
 #include "src/GameState.hpp"
 #include "src/GameRules.hpp"
 #include "src/Move.hpp"
 #include "src/Search.hpp"
+#include "src/PositionRecord.hpp"
+#include "src/Notation.hpp"
+#include "src/Protocol.hpp"
 
 using namespace std;
 
-// Convertit un coup interne (0-15) en string pour l'Arbitre (1-16)
-string move_to_string(const Move &m)
-{
-    // On ajoute 1 pour passer de l'index 0-15 à 1-16
-    string s = to_string(m.hole + 1);
-
-    if (m.type == MoveType::RED)
-        s += "R";
-    else if (m.type == MoveType::BLUE)
-        s += "B";
-    else if (m.type == MoveType::TRANS_AS_RED)
-        s += "TR";
-    else if (m.type == MoveType::TRANS_AS_BLUE)
-        s += "TB";
-
-    return s;
-}
-
-// Convertit le string de l'Arbitre (1-16) en coup interne (0-15)
-Move string_to_move(const string &s)
-{
-    size_t num_len = 0;
-    while (num_len < s.size() && isdigit(s[num_len]))
-        num_len++;
-
-    int hole = 0;
-    try
-    {
-        int parsed_hole = stoi(s.substr(0, num_len));
-        // Conversion en index 0-15
-        hole = parsed_hole - 1;
-    }
-    catch (...)
-    {
-        return {255, MoveType::RED}; // Coup invalide
-    }
-
-    // Extraction du type de coup
-    string raw_suffix = s.substr(num_len);
-    string suffix = "";
-
-    // Nettoyage et normalisation (supprime les espaces/\r et met en majuscules)
-    for (char c : raw_suffix) {
-        if (!isspace(c)) {
-            suffix += toupper(c);
-        }
-    }
-
-    MoveType type = MoveType::RED;
-
-    if (suffix == "R")
-        type = MoveType::RED;
-    else if (suffix == "B")
-        type = MoveType::BLUE;
-    else if (suffix == "TR")
-        type = MoveType::TRANS_AS_RED;
-    else if (suffix == "TB")
-        type = MoveType::TRANS_AS_BLUE;
-
-    return {hole, type};
-}
-
-int main()
+int main(int argc, char *argv[])
 {
     // Optimisation des flux d'entrée/sortie
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    // "player.exe bench [profondeur]" : bench de référence puis sortie
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        Protocol::run_bench(argc > 2 ? atoi(argv[2]) : Protocol::BENCH_DEPTH, cout);
+        return 0;
+    }
+
     GameState state;
     int my_player_id = 0;
     string input_line;
 
+    // Enregistrement optionnel des positions cherchées (AI_RECORD=fichier)
+    // Chaque record est écrit sur disque dès la fin de sa recherche, avant l'envoi du coup :
+    // l'Arbitre tue le processus juste après RESULT, et une partie peut finir sans RESULT
+    // (timeout, coup invalide). Le résultat suit dans un record de fin (Records::make_game_end).
+    Records::RecordWriter recorder;
+    if (const char *record_path = getenv("AI_RECORD"))
+        recorder.open(record_path);
+
+    auto record_search = [&](const Move &best_move)
+    {
+        if (!recorder.is_open() || best_move.hole >= NB_HOLES)
+            return; // Pas de recherche (aucun coup légal) : rien à enregistrer
+        Records::PositionRecord rec;
+        rec.state = state;
+        rec.side_to_move = static_cast<uint8_t>(my_player_id);
+        rec.search_score = AI::main_context.info.score;
+        rec.best_move = best_move;
+        recorder.push(rec);
+        recorder.flush();
+    };
+
     // Boucle principale
     while (getline(cin, input_line))
     {
@@ -93,6 +63,13 @@ int main()
         if (input_line.empty())
             continue;
 
+        // 0. MODE MOTEUR (position / go / stop / bench), uniquement en première commande
+        if (input_line == "protocol" && my_player_id == 0)
+        {
+            Protocol::run(cin, cout);
+            break;
+        }
+
         // 1. GESTION START
         if (input_line == "START")
         {
@@ -100,16 +77,36 @@ int main()
 
             // Je joue le premier coup
             Move best_move = AI::find_best_move(state, my_player_id, 2);
+            record_search(best_move);
 
             GameRules::apply_move(state, best_move, my_player_id);
 
-            cout << move_to_string(best_move) << endl;
+            cout << Notation::move_to_string(best_move) << endl;
             continue;
         }
 
         // 2. GESTION END
         if (input_line == "END" || input_line.find("RESULT") != string::npos)
         {
+            // "RESULT <score_p1> <score_p2>" : sinon on se base sur le plateau local
+            int final_p1 = state.score_p1, final_p2 = state.score_p2;
+            size_t result_pos = input_line.find("RESULT");
+            if (result_pos != string::npos)
+            {
+                int p1 = 0, p2 = 0;
+                istringstream result_stream(input_line.substr(result_pos + 6));
+                if (result_stream >> p1 >> p2)
+                {
+                    final_p1 = p1;
+                    final_p2 = p2;
+                }
+            }
+
+            if (recorder.is_open() && my_player_id != 0)
+            {
+                recorder.push(Records::make_game_end(final_p1, final_p2, my_player_id));
+                recorder.flush();
+            }
             break;
         }
 
@@ -121,7 +118,7 @@ int main()
 
         int opponent_id = (my_player_id == 1) ? 2 : 1;
 
-        Move opp_move = string_to_move(input_line);
+        Move opp_move = Notation::string_to_move(input_line);
 
         if (opp_move.hole >= 0 && opp_move.hole < 16)
         {
@@ -131,6 +128,7 @@ int main()
 
         // 4. A MON TOUR DE JOUER
         Move best_move = AI::find_best_move(state, my_player_id, 2.0);
+        record_search(best_move);
 
         if (best_move.hole == 255)
         {
@@ -142,7 +140,7 @@ int main()
         GameRules::apply_move(state, best_move, my_player_id);
 
         // Envoyer le coup (traduit en 1-16 automatiquement)
-        cout << move_to_string(best_move) << endl;
+        cout << Notation::move_to_string(best_move) << endl;
     }
 
     return 0;
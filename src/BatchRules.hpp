@@ -0,0 +1,303 @@
+#pragma once
+
+#include "GameState.hpp"
+#include "Move.hpp"
+#include <cstdint>
+
+// Simulateur par lots : N parties stockées en Structure-of-Arrays (par case, par voie)
+// et jouées en parallèle. Chaque boucle porte sur les voies (lanes) d'une même case,
+// sans branchement dépendant des données, pour que le compilateur la vectorise (-O3).
+namespace BatchRules {
+
+    constexpr int DEFAULT_LANES = 64; // 64 voies = une ligne de cache par case
+
+    template <int LANES = DEFAULT_LANES>
+    struct BatchState {
+        static_assert(LANES > 0 && LANES % 16 == 0, "LANES doit être un multiple de 16");
+
+        // board[case][voie] : même indexation de case que GameState::board (trou * 3 + couleur)
+        alignas(64) uint8_t board[TOTAL_CELLS][LANES];
+        alignas(64) uint16_t score_p1[LANES];
+        alignas(64) uint16_t score_p2[LANES];
+        alignas(64) uint16_t moves_count[LANES];
+
+        // Charge un GameState dans une voie
+        inline void load(int lane, const GameState& state) {
+            for (int c = 0; c < TOTAL_CELLS; ++c) board[c][lane] = state.board[c];
+            score_p1[lane] = state.score_p1;
+            score_p2[lane] = state.score_p2;
+            moves_count[lane] = state.moves_count;
+        }
+
+        // Remplit toutes les voies avec le même état
+        inline void fill(const GameState& state) {
+            for (int lane = 0; lane < LANES; ++lane) load(lane, state);
+        }
+
+        // Extrait l'état d'une voie
+        inline GameState store(int lane) const {
+            GameState state;
+            for (int c = 0; c < TOTAL_CELLS; ++c) state.board[c] = board[c][lane];
+            state.score_p1 = score_p1[lane];
+            state.score_p2 = score_p2[lane];
+            state.moves_count = moves_count[lane];
+            return state;
+        }
+    };
+
+    // Équivalent de GameRules::is_game_over pour chaque voie (1 = terminée, 0 = en cours)
+    template <int LANES>
+    inline void is_game_over(const BatchState<LANES>& batch, uint8_t* over) {
+        for (int l = 0; l < LANES; ++l) {
+            int captured = batch.score_p1[l] + batch.score_p2[l];
+            over[l] = static_cast<uint8_t>((batch.score_p1[l] >= 49) | (batch.score_p2[l] >= 49) |
+                                           (batch.moves_count[l] >= 400) | (TOTAL_SEEDS_START - captured < 10));
+        }
+    }
+
+    // Masque des coups légaux de chaque voie : le bit (trou * 4 + type) est levé si le coup
+    // Move(trou, type) est jouable par players[voie]. Même ensemble que AI::generate_moves.
+    template <int LANES>
+    inline void legal_moves_mask(const BatchState<LANES>& batch, const uint8_t* players, uint64_t* masks) {
+        for (int l = 0; l < LANES; ++l) masks[l] = 0;
+
+        for (int h = 0; h < NB_HOLES; ++h) {
+            const uint8_t* r = batch.board[h * 3 + RED];
+            const uint8_t* b = batch.board[h * 3 + BLUE];
+            const uint8_t* t = batch.board[h * 3 + TRANSPARENT];
+            const uint64_t owner = (h % 2 == 0) ? 1 : 2; // Joueur 1 : trous d'indice pair
+
+            for (int l = 0; l < LANES; ++l) {
+                uint64_t mine = (players[l] == owner);
+                uint64_t bits = (uint64_t)(r[l] > 0) << (int)MoveType::RED |
+                                (uint64_t)(b[l] > 0) << (int)MoveType::BLUE |
+                                (uint64_t)(t[l] > 0) * (uint64_t)(1u << (int)MoveType::TRANS_AS_RED | 1u << (int)MoveType::TRANS_AS_BLUE);
+                masks[l] |= (bits * mine) << (h * 4);
+            }
+        }
+    }
+
+    // Sélection sans branchement : a là où mask vaut 0xFF, b là où il vaut 0
+    inline uint8_t select8(uint8_t mask, uint8_t a, uint8_t b) {
+        return (uint8_t)((a & mask) | (b & ~mask));
+    }
+
+    // Division par 15 exacte pour 0 <= n <= 255 (multiplication 16 bits, vectorisable en SSE2)
+    inline uint8_t div15(uint8_t n) {
+        return (uint8_t)(((uint16_t)n * 137) >> 11);
+    }
+
+    // Applique un coup par voie, en lockstep. Résultat identique à GameRules::apply_move
+    // voie par voie. Les coups doivent venir d'un trou du joueur (cf. legal_moves_mask) ;
+    // une voie dont le coup a hole >= NB_HOLES est laissée intacte (voie inactive).
+    //
+    // Au lieu de semer graine par graine, on calcule directement ce que reçoit chaque trou :
+    // les k trous éligibles (15 en rouge, les 8 trous adverses en bleu) reçoivent les graines
+    // dans l'ordre, transparentes d'abord, donc la graine n°j tombe dans le trou de rang j % k.
+    // Les conditions par voie sont des masques 0x00/0xFF pour que chaque boucle soit vectorisée.
+    template <int LANES>
+    inline void apply_moves(BatchState<LANES>& batch, const Move* moves, const uint8_t* players) {
+        alignas(64) uint8_t start[LANES];     // Trou de départ
+        alignas(64) uint8_t active[LANES];    // 0xFF si la voie joue un coup
+        alignas(64) uint8_t blue[LANES];      // 0xFF en mode bleu (on ne sème que chez l'adversaire)
+        alignas(64) uint8_t trans[LANES];     // 0xFF si le coup prend aussi les transparentes
+        alignas(64) uint8_t p1[LANES];        // 0xFF si c'est le joueur 1 qui joue
+        alignas(64) uint8_t n_trans[LANES];   // Graines transparentes prélevées
+        alignas(64) uint8_t n_color[LANES];   // Graines colorées prélevées
+        alignas(64) uint8_t last[LANES];      // Dernier trou semé
+        alignas(64) uint8_t chain[NB_HOLES][LANES]; // 0xFF si le trou est capturé
+        alignas(64) uint16_t captured[LANES];
+
+        for (int l = 0; l < LANES; ++l) {
+            uint8_t type = static_cast<uint8_t>(moves[l].type);
+            active[l] = (moves[l].hole < NB_HOLES) ? 0xFF : 0;
+            start[l] = moves[l].hole & (NB_HOLES - 1);
+            blue[l] = ((type == (uint8_t)MoveType::BLUE) | (type == (uint8_t)MoveType::TRANS_AS_BLUE)) ? 0xFF : 0;
+            trans[l] = (type >= (uint8_t)MoveType::TRANS_AS_RED) ? 0xFF : 0;
+            p1[l] = (players[l] == 1) ? 0xFF : 0;
+            n_trans[l] = 0;
+            n_color[l] = 0;
+            captured[l] = 0;
+        }
+
+        // 1. PRÉLÈVEMENT : on balaie les 16 trous et on ne garde que le trou de départ de chaque voie
+        for (int h = 0; h < NB_HOLES; ++h) {
+            uint8_t* r = batch.board[h * 3 + RED];
+            uint8_t* b = batch.board[h * 3 + BLUE];
+            uint8_t* t = batch.board[h * 3 + TRANSPARENT];
+            for (int l = 0; l < LANES; ++l) {
+                uint8_t here = active[l] & ((start[l] == h) ? 0xFF : 0);
+                uint8_t take_red = here & ~blue[l];
+                uint8_t take_blue = here & blue[l];
+                uint8_t take_trans = here & trans[l];
+
+                n_color[l] += (r[l] & take_red) + (b[l] & take_blue);
+                n_trans[l] += t[l] & take_trans;
+                r[l] &= ~take_red;
+                b[l] &= ~take_blue;
+                t[l] &= ~take_trans;
+            }
+        }
+
+        // 2. SEMAILLE : nombre de graines reçues par chaque trou selon son rang parmi les éligibles
+        for (int h = 0; h < NB_HOLES; ++h) {
+            uint8_t* r = batch.board[h * 3 + RED];
+            uint8_t* b = batch.board[h * 3 + BLUE];
+            uint8_t* t = batch.board[h * 3 + TRANSPARENT];
+            const uint8_t h_is_p1 = (h % 2 == 0) ? 0xFF : 0;
+            for (int l = 0; l < LANES; ++l) {
+                uint8_t d = (uint8_t)(h - start[l]) & (NB_HOLES - 1); // Distance depuis le trou de départ
+                uint8_t own = ~(h_is_p1 ^ p1[l]);
+                uint8_t eligible = active[l] & ((d != 0) ? 0xFF : 0) & ~(blue[l] & own);
+                uint8_t k = select8(blue[l], 8, 15);
+                uint8_t rank = select8(blue[l], (uint8_t)(d - 1) >> 1, (uint8_t)(d - 1));
+
+                // Graines d'indice j dans [0, n) tombant au rang rank : n / k + (rank < n % k)
+                uint8_t n1 = n_trans[l];
+                uint8_t n2 = n_trans[l] + n_color[l];
+                uint8_t q1 = select8(blue[l], n1 >> 3, div15(n1));
+                uint8_t q2 = select8(blue[l], n2 >> 3, div15(n2));
+                uint8_t c1 = q1 + (rank < (uint8_t)(n1 - q1 * k));
+                uint8_t c2 = q2 + (rank < (uint8_t)(n2 - q2 * k));
+
+                uint8_t add_trans = c1 & eligible;
+                uint8_t add_color = (uint8_t)(c2 - c1) & eligible;
+                t[l] += add_trans;
+                r[l] += add_color & ~blue[l];
+                b[l] += add_color & blue[l];
+            }
+        }
+
+        // Dernier trou semé : rang (n - 1) % k, ou le trou de départ si aucune graine
+        for (int l = 0; l < LANES; ++l) {
+            uint8_t n = n_trans[l] + n_color[l];
+            uint8_t k = select8(blue[l], 8, 15);
+            uint8_t q = select8(blue[l], (uint8_t)(n - 1) >> 3, div15((uint8_t)(n - 1)));
+            uint8_t rank = (uint8_t)(n - 1 - q * k);
+            uint8_t offset = select8(blue[l], (uint8_t)(2 * rank + 1), (uint8_t)(rank + 1));
+            last[l] = select8((n != 0) ? 0xFF : 0, (uint8_t)(start[l] + offset) & (NB_HOLES - 1), start[l]);
+        }
+
+        // 3. CAPTURE : un trou est pris s'il a 2 ou 3 graines et que le trou suivant est pris
+        // (ou qu'il est le dernier trou semé). Deux balayages descendants suffisent à propager
+        // la chaîne en remontant depuis le dernier trou, y compris en repassant par le trou 16.
+        for (int h = 0; h < NB_HOLES; ++h)
+            for (int l = 0; l < LANES; ++l) chain[h][l] = 0;
+
+        for (int sweep = 0; sweep < 2; ++sweep) {
+            for (int h = NB_HOLES - 1; h >= 0; --h) {
+                const uint8_t* r = batch.board[h * 3 + RED];
+                const uint8_t* b = batch.board[h * 3 + BLUE];
+                const uint8_t* t = batch.board[h * 3 + TRANSPARENT];
+                const uint8_t* after = chain[(h + 1) % NB_HOLES];
+                for (int l = 0; l < LANES; ++l) {
+                    uint8_t total = r[l] + b[l] + t[l];
+                    uint8_t capturable = ((total == 2) | (total == 3)) ? 0xFF : 0;
+                    uint8_t is_last = (last[l] == h) ? 0xFF : 0;
+                    chain[h][l] = capturable & active[l] & (is_last | after[l]);
+                }
+            }
+        }
+
+        for (int h = 0; h < NB_HOLES; ++h) {
+            uint8_t* r = batch.board[h * 3 + RED];
+            uint8_t* b = batch.board[h * 3 + BLUE];
+            uint8_t* t = batch.board[h * 3 + TRANSPARENT];
+            for (int l = 0; l < LANES; ++l) {
+                uint8_t take = chain[h][l];
+                captured[l] += (uint8_t)((r[l] + b[l] + t[l]) & take);
+                r[l] &= ~take;
+                b[l] &= ~take;
+                t[l] &= ~take;
+            }
+        }
+
+        // 4. Scores et compteur de tours
+        for (int l = 0; l < LANES; ++l) {
+            uint16_t mask_p1 = (uint16_t)(int8_t)p1[l]; // 0xFFFF ou 0
+            batch.score_p1[l] += captured[l] & mask_p1;
+            batch.score_p2[l] += captured[l] & ~mask_p1;
+            batch.moves_count[l] += active[l] & 1;
+        }
+    }
+
+    // Générateur xorshift64* par voie pour les parties aléatoires
+    template <int LANES>
+    struct BatchRng {
+        uint64_t s[LANES];
+
+        explicit BatchRng(uint64_t seed) {
+            for (int l = 0; l < LANES; ++l) {
+                // splitmix64 pour décorréler les voies
+                uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (uint64_t)(l + 1);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                s[l] = (z ^ (z >> 31)) | 1;
+            }
+        }
+
+        inline uint64_t next(int l) {
+            s[l] ^= s[l] >> 12;
+            s[l] ^= s[l] << 25;
+            s[l] ^= s[l] >> 27;
+            return s[l] * 0x2545F4914F6CDD1DULL;
+        }
+    };
+
+    // Position du pick-ième bit levé de m (pick < popcount(m)), par dichotomie sur les moitiés
+    inline int select_bit(uint64_t m, int pick) {
+        int bit = 0;
+        for (int width = 32; width > 0; width >>= 1) {
+            uint64_t low = m & ((1ULL << width) - 1);
+            int n = __builtin_popcountll(low);
+            bool high = pick >= n;
+            pick -= high ? n : 0;
+            bit += high ? width : 0;
+            m = high ? (m >> width) : low;
+        }
+        return bit;
+    }
+
+    // Joue des parties aléatoires sur toutes les voies jusqu'à la fin de chacune.
+    // players : joueur au trait de chaque voie (mis à jour). Une voie dont le joueur n'a plus
+    // de coup est considérée comme terminée (famine). Retourne le nombre total de coups joués.
+    template <int LANES>
+    inline uint64_t random_playouts(BatchState<LANES>& batch, uint8_t* players, BatchRng<LANES>& rng) {
+        alignas(64) uint8_t over[LANES];
+        alignas(64) uint8_t done[LANES];
+        alignas(64) uint64_t masks[LANES];
+        Move moves[LANES];
+        uint64_t plies = 0;
+
+        for (int l = 0; l < LANES; ++l) done[l] = 0;
+
+        while (true) {
+            is_game_over(batch, over);
+            legal_moves_mask(batch, players, masks);
+
+            int running = 0;
+            for (int l = 0; l < LANES; ++l) {
+                done[l] |= over[l] | (masks[l] == 0);
+                running += !done[l];
+            }
+            if (running == 0) break;
+
+            // Tirage uniforme d'un bit levé du masque (sélection du i-ème bit)
+            for (int l = 0; l < LANES; ++l) {
+                if (done[l]) {
+                    moves[l] = Move();
+                    continue;
+                }
+                uint64_t m = masks[l];
+                int pick = (int)(((rng.next(l) >> 32) * (uint64_t)__builtin_popcountll(m)) >> 32);
+                int bit = select_bit(m, pick);
+                moves[l] = Move(bit >> 2, static_cast<MoveType>(bit & 3));
+            }
+
+            apply_moves(batch, moves, players);
+            plies += running;
+            for (int l = 0; l < LANES; ++l) players[l] = done[l] ? players[l] : (uint8_t)(3 - players[l]);
+        }
+        return plies;
+    }
+};
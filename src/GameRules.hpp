@@ -2,6 +2,7 @@
 
 #include "GameState.hpp"
 #include "Move.hpp"
+#include "Profiler.hpp"
 #include <vector>
 #include <cmath>
 
@@ -9,7 +10,8 @@ namespace GameRules {
     // Fonction qui vérifie si la partie est terminée
     inline static bool is_game_over(const GameState& state) {
         // Condition de fin : un joueur a la majorité absolue (49 graines ou plus sur 96) ou 400 coups totaux joués ou moins de 10 graines sur le plateau
-        return (state.score_p1 >= 49 || state.score_p2 >= 49 || state.moves_count >= 400 || state.count_all_seeds() < 10);
+        return (state.score_p1 >= WINNING_SCORE || state.score_p2 >= WINNING_SCORE || state.moves_count >= MAX_MOVES ||
+                state.count_all_seeds() < MIN_SEEDS_ON_BOARD);
     }
 
     // Retourne vrai si le trou appartient au joueur 1 (Trous 1, 3, 5... -> Indices 0, 2, 4...) et faux si au joueur 2 (Trous 2, 4, 6... -> Indices 1, 3, 5...)
@@ -48,6 +50,8 @@ namespace GameRules {
 
     // Applique un coup sur un état du jeu. Modifie l'état en place.
     inline void apply_move(GameState& state, const Move& move, int player_id) {
+        PROFILE_ZONE(APPLY_MOVE);
+
         if (move.hole >= NB_HOLES) {
             return; // On ignore les coups invalides
         }
@@ -7,6 +7,9 @@ constexpr int NB_HOLES = 16; // Nombre de trous sur le plateau
 constexpr int NB_COLORS = 3; // Rouge, Bleu, Transparent
 constexpr int TOTAL_CELLS = NB_HOLES * NB_COLORS; // 16 * 3 = 48 cases mémoires
 constexpr int TOTAL_SEEDS_START = NB_HOLES * 2 * NB_COLORS; // 16 trous * 2 graines * 3 couleurs = 96 graines au départ
+constexpr int WINNING_SCORE = 49;      // Majorité absolue : 49 graines capturées ou plus
+constexpr int MAX_MOVES = 400;         // Nombre maximal de coups d'une partie
+constexpr int MIN_SEEDS_ON_BOARD = 10; // En dessous, la partie s'arrête (graines restantes non comptées)
 
 // Indices pour les couleurs
 constexpr int RED = 0;
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "GameState.hpp"
+#include "GameRules.hpp"
+#include "Move.hpp"
+#include <cctype>
+#include <sstream>
+#include <string>
+
+// Conversions texte <-> coups / positions, partagées par le protocole Arbitre et le mode moteur
+namespace Notation
+{
+    // Convertit un coup interne (0-15) en string pour l'Arbitre (1-16)
+    inline std::string move_to_string(const Move &m)
+    {
+        // On ajoute 1 pour passer de l'index 0-15 à 1-16
+        std::string s = std::to_string(m.hole + 1);
+
+        if (m.type == MoveType::RED)
+            s += "R";
+        else if (m.type == MoveType::BLUE)
+            s += "B";
+        else if (m.type == MoveType::TRANS_AS_RED)
+            s += "TR";
+        else if (m.type == MoveType::TRANS_AS_BLUE)
+            s += "TB";
+
+        return s;
+    }
+
+    // Convertit le string de l'Arbitre (1-16) en coup interne (0-15)
+    inline Move string_to_move(const std::string &s)
+    {
+        size_t num_len = 0;
+        while (num_len < s.size() && isdigit(s[num_len]))
+            num_len++;
+
+        int hole = 0;
+        try
+        {
+            int parsed_hole = std::stoi(s.substr(0, num_len));
+            // Conversion en index 0-15
+            hole = parsed_hole - 1;
+        }
+        catch (...)
+        {
+            return {255, MoveType::RED}; // Coup invalide
+        }
+
+        // Extraction du type de coup
+        std::string raw_suffix = s.substr(num_len);
+        std::string suffix = "";
+
+        // Nettoyage et normalisation (supprime les espaces/\r et met en majuscules)
+        for (char c : raw_suffix) {
+            if (!isspace(c)) {
+                suffix += toupper(c);
+            }
+        }
+
+        MoveType type = MoveType::RED;
+
+        if (suffix == "R")
+            type = MoveType::RED;
+        else if (suffix == "B")
+            type = MoveType::BLUE;
+        else if (suffix == "TR")
+            type = MoveType::TRANS_AS_RED;
+        else if (suffix == "TB")
+            type = MoveType::TRANS_AS_BLUE;
+
+        return {hole, type};
+    }
+
+    // Écrit une suite de coups séparés par des espaces (variation principale)
+    template <typename MoveList>
+    inline std::string pv_to_string(const MoveList &moves)
+    {
+        std::string s;
+        for (int i = 0; i < moves.size(); ++i)
+        {
+            if (i > 0)
+                s += ' ';
+            s += move_to_string(moves[i]);
+        }
+        return s;
+    }
+
+    // Vérifie qu'un coup est jouable (même règles que la validation de l'Arbitre)
+    inline bool is_legal_move(const GameState &state, const Move &m, int player_id)
+    {
+        if (m.hole >= NB_HOLES || !GameRules::is_current_player_hole(m.hole, player_id))
+            return false;
+        if (m.type == MoveType::RED)
+            return state.get_seeds(m.hole, RED) > 0;
+        if (m.type == MoveType::BLUE)
+            return state.get_seeds(m.hole, BLUE) > 0;
+        return state.get_seeds(m.hole, TRANSPARENT) > 0;
+    }
+
+    // Écrit une position sous la forme :
+    //   r,b,t/r,b,t/.../r,b,t <score_p1> <score_p2> <joueur au trait> <moves_count>
+    // (16 trous, de 1 à 16, graines rouges, bleues et transparentes)
+    inline std::string board_to_string(const GameState &state, int side_to_move)
+    {
+        std::string s;
+        for (int i = 0; i < NB_HOLES; ++i)
+        {
+            if (i > 0)
+                s += '/';
+            s += std::to_string(state.get_seeds(i, RED)) + ',' + std::to_string(state.get_seeds(i, BLUE)) + ',' +
+                 std::to_string(state.get_seeds(i, TRANSPARENT));
+        }
+        s += ' ' + std::to_string(state.score_p1) + ' ' + std::to_string(state.score_p2) + ' ' +
+             std::to_string(side_to_move) + ' ' + std::to_string(state.moves_count);
+        return s;
+    }
+
+    // Lit une position écrite par board_to_string. Retourne false si le format est invalide.
+    inline bool parse_board(std::istream &in, GameState &state, int &side_to_move)
+    {
+        std::string holes;
+        int score_p1, score_p2, side, moves_count;
+        if (!(in >> holes >> score_p1 >> score_p2 >> side >> moves_count))
+            return false;
+        if ((side != 1 && side != 2) || score_p1 < 0 || score_p2 < 0 || moves_count < 0)
+            return false;
+
+        std::istringstream hs(holes);
+        for (int i = 0; i < NB_HOLES; ++i)
+        {
+            int r, b, t;
+            char sep1, sep2, sep3 = '/';
+            if (!(hs >> r >> sep1 >> b >> sep2 >> t) || sep1 != ',' || sep2 != ',')
+                return false;
+            if (r < 0 || b < 0 || t < 0 || r > 255 || b > 255 || t > 255)
+                return false;
+            if (i < NB_HOLES - 1 && (!(hs >> sep3) || sep3 != '/'))
+                return false;
+            state.set_seeds(i, RED, r);
+            state.set_seeds(i, BLUE, b);
+            state.set_seeds(i, TRANSPARENT, t);
+        }
+        state.score_p1 = static_cast<uint16_t>(score_p1);
+        state.score_p2 = static_cast<uint16_t>(score_p2);
+        state.moves_count = static_cast<uint16_t>(moves_count);
+        side_to_move = side;
+        return true;
+    }
+
+    // Lit "startpos | board <position>" puis "[moves <coup> ...]" et rejoue les coups.
+    // Retourne false si la position ou un des coups est invalide.
+    inline bool parse_position(std::istream &in, GameState &state, int &side_to_move)
+    {
+        std::string token;
+        if (!(in >> token))
+            return false;
+
+        if (token == "startpos")
+        {
+            state = GameState();
+            side_to_move = 1;
+        }
+        else if (token == "board")
+        {
+            if (!parse_board(in, state, side_to_move))
+                return false;
+        }
+        else
+            return false;
+
+        if (!(in >> token))
+            return true;
+        if (token != "moves")
+            return false;
+
+        while (in >> token)
+        {
+            Move m = string_to_move(token);
+            if (!is_legal_move(state, m, side_to_move))
+                return false;
+            GameRules::apply_move(state, m, side_to_move);
+            side_to_move = (side_to_move == 1) ? 2 : 1;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,414 @@
+#pragma once
+
+#include "GameState.hpp"
+#include "Move.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Format binaire compact pour enregistrer les positions jouées (données d'entraînement).
+//
+// Fichier : en-tête de 4 octets "AWR1", puis une suite de records de taille variable :
+//   [0]      taille totale du record en octets (permet de sauter sans décoder)
+//   [1]      drapeaux : bit 0 = trait au joueur 2, bits 1-2 = résultat, bit 3 = meilleur coup présent,
+//            bit 4 = record de fin de partie
+//   [2] [3]  score_p1, score_p2
+//   varint   moves_count
+//   varint   score de la recherche (zigzag)
+//   [1]      meilleur coup (trou * 4 + type), si le bit 3 est levé
+//   [6]      bitmap des 48 cases non vides
+//   nibbles  une valeur par case non vide : v < 15 -> v + 1 graines, v = 15 -> octet d'extension
+//   octets   extensions (cases à 16 graines ou plus), dans l'ordre des cases
+//
+// Les positions sont écrites dès leur recherche, avec un résultat inconnu. À la fin de la partie,
+// un record de fin (bit 4 : scores finaux, résultat, joueur qui enregistre dans le bit 0, plateau
+// vide) donne le résultat des positions précédentes de ce joueur : cf. resolve_results.
+namespace Records
+{
+    constexpr char MAGIC[4] = {'A', 'W', 'R', '1'};
+    constexpr int HEADER_SIZE = 4;
+    constexpr int MAX_RECORD_SIZE = 4 + 3 + 5 + 1 + 6 + TOTAL_CELLS / 2 + TOTAL_CELLS; // 91 octets au pire
+
+    enum class GameResult : uint8_t
+    {
+        UNKNOWN = 0,
+        P1_WIN = 1,
+        P2_WIN = 2,
+        DRAW = 3
+    };
+
+    struct PositionRecord
+    {
+        GameState state;                          // Plateau, scores et compteur de coups
+        uint8_t side_to_move = 1;                 // Joueur au trait (1 ou 2)
+        int32_t search_score = 0;                 // Score de la recherche (point de vue du joueur au trait)
+        Move best_move;                           // Coup choisi (hole = 255 si aucun)
+        GameResult result = GameResult::UNKNOWN;  // Résultat final de la partie
+        bool game_end = false;                    // Record de fin de partie (scores finaux, sans plateau)
+    };
+
+    // Résultat d'une partie à partir des scores finaux
+    inline GameResult result_from_scores(int score_p1, int score_p2)
+    {
+        if (score_p1 > score_p2)
+            return GameResult::P1_WIN;
+        if (score_p2 > score_p1)
+            return GameResult::P2_WIN;
+        return GameResult::DRAW;
+    }
+
+    // --- ENCODAGE ---
+    inline uint8_t *put_varint(uint8_t *out, uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            *out++ = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(v);
+        return out;
+    }
+
+    inline const uint8_t *get_varint(const uint8_t *in, const uint8_t *end, uint32_t &v)
+    {
+        v = 0;
+        for (int shift = 0; shift < 35 && in < end; shift += 7)
+        {
+            uint8_t byte = *in++;
+            v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return in;
+        }
+        return nullptr; // Varint tronqué ou trop long
+    }
+
+    // Écrit le record dans out (au moins MAX_RECORD_SIZE octets). Retourne la taille écrite.
+    inline int encode(const PositionRecord &rec, uint8_t *out)
+    {
+        const GameState &s = rec.state;
+        bool has_move = rec.best_move.hole < NB_HOLES;
+
+        uint8_t *p = out + 1; // out[0] = taille, écrite à la fin
+        *p++ = static_cast<uint8_t>((rec.side_to_move == 2 ? 1 : 0) | (static_cast<uint8_t>(rec.result) << 1) | (has_move ? 8 : 0) |
+                                   (rec.game_end ? 16 : 0));
+        *p++ = static_cast<uint8_t>(s.score_p1);
+        *p++ = static_cast<uint8_t>(s.score_p2);
+        p = put_varint(p, s.moves_count);
+        p = put_varint(p, (static_cast<uint32_t>(rec.search_score) << 1) ^ static_cast<uint32_t>(rec.search_score >> 31));
+        if (has_move)
+            *p++ = static_cast<uint8_t>(rec.best_move.hole * 4 + static_cast<int>(rec.best_move.type));
+
+        uint8_t *bitmap = p;
+        std::memset(bitmap, 0, 6);
+        p += 6;
+
+        uint8_t *nibbles = p;
+        int n = 0;
+        uint8_t extensions[TOTAL_CELLS];
+        int n_ext = 0;
+        for (int c = 0; c < TOTAL_CELLS; ++c)
+        {
+            uint8_t count = s.board[c];
+            if (count == 0)
+                continue;
+            bitmap[c >> 3] |= static_cast<uint8_t>(1 << (c & 7));
+            uint8_t v = count < 16 ? static_cast<uint8_t>(count - 1) : 15;
+            if (v == 15)
+                extensions[n_ext++] = count;
+            if (n & 1)
+                nibbles[n >> 1] |= static_cast<uint8_t>(v << 4);
+            else
+                nibbles[n >> 1] = v;
+            n++;
+        }
+        p += (n + 1) >> 1;
+        std::memcpy(p, extensions, n_ext);
+        p += n_ext;
+
+        out[0] = static_cast<uint8_t>(p - out);
+        return out[0];
+    }
+
+    // Décode un record. Retourne false si les données sont incohérentes.
+    inline bool decode(const uint8_t *in, PositionRecord &rec)
+    {
+        const uint8_t *end = in + in[0];
+        const uint8_t *p = in + 1;
+        if (end - p < 3)
+            return false;
+
+        uint8_t flags = *p++;
+        rec.side_to_move = (flags & 1) ? 2 : 1;
+        rec.result = static_cast<GameResult>((flags >> 1) & 3);
+        rec.game_end = (flags & 16) != 0;
+        rec.state.score_p1 = *p++;
+        rec.state.score_p2 = *p++;
+
+        uint32_t v;
+        if (!(p = get_varint(p, end, v)))
+            return false;
+        rec.state.moves_count = static_cast<uint16_t>(v);
+        if (!(p = get_varint(p, end, v)))
+            return false;
+        rec.search_score = static_cast<int32_t>((v >> 1) ^ (0u - (v & 1)));
+
+        rec.best_move = Move();
+        if (flags & 8)
+        {
+            if (p >= end)
+                return false;
+            rec.best_move = Move(*p >> 2, static_cast<MoveType>(*p & 3));
+            p++;
+        }
+
+        if (end - p < 6)
+            return false;
+        uint64_t bitmap = 0;
+        for (int i = 0; i < 6; ++i)
+            bitmap |= static_cast<uint64_t>(p[i]) << (8 * i);
+        p += 6;
+
+        const uint8_t *nibbles = p;
+        const uint8_t *ext = p + ((__builtin_popcountll(bitmap) + 1) >> 1);
+        if (ext > end)
+            return false;
+
+        // On ne parcourt que les cases non vides (bits levés du bitmap)
+        rec.state.board.fill(0);
+        for (int k = 0; bitmap; ++k, bitmap &= bitmap - 1)
+        {
+            int c = __builtin_ctzll(bitmap);
+            uint8_t nib = (nibbles[k >> 1] >> ((k & 1) * 4)) & 15;
+            if (nib < 15)
+                rec.state.board[c] = nib + 1;
+            else if (ext < end)
+                rec.state.board[c] = *ext++;
+            else
+                return false;
+        }
+        return ext == end;
+    }
+
+    // Record de fin de partie pour le joueur qui enregistre
+    inline PositionRecord make_game_end(int score_p1, int score_p2, int player_id)
+    {
+        PositionRecord rec;
+        rec.state.score_p1 = static_cast<uint16_t>(score_p1);
+        rec.state.score_p2 = static_cast<uint16_t>(score_p2);
+        rec.state.board.fill(0);
+        rec.side_to_move = static_cast<uint8_t>(player_id);
+        rec.result = result_from_scores(score_p1, score_p2);
+        rec.game_end = true;
+        return rec;
+    }
+
+    // Reporte le résultat de chaque record de fin sur les positions de sa partie : les positions
+    // précédentes du même joueur, tant que moves_count décroît en remontant (une hausse marque la
+    // partie d'avant). Une partie interrompue sans record de fin garde un résultat inconnu.
+    inline void resolve_results(std::vector<PositionRecord> &records)
+    {
+        GameResult pending[3] = {GameResult::UNKNOWN, GameResult::UNKNOWN, GameResult::UNKNOWN};
+        int last_moves[3] = {0, 0, 0};
+        for (size_t i = records.size(); i-- > 0;)
+        {
+            PositionRecord &rec = records[i];
+            int player = rec.side_to_move;
+            if (rec.game_end)
+            {
+                pending[player] = rec.result;
+                last_moves[player] = 0x10000;
+                continue;
+            }
+            if (rec.state.moves_count >= last_moves[player])
+                pending[player] = GameResult::UNKNOWN; // Partie précédente
+            last_moves[player] = rec.state.moves_count;
+            if (rec.result == GameResult::UNKNOWN)
+                rec.result = pending[player];
+        }
+    }
+
+    // --- ÉCRITURE ---
+    // Écrivain bufferisé : push() encode directement dans un tampon mémoire, les écritures
+    // disque se font par blocs de BUFFER_SIZE octets.
+    class RecordWriter
+    {
+    public:
+        static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+        RecordWriter() { buffer.resize(BUFFER_SIZE); }
+        ~RecordWriter() { close(); }
+
+        RecordWriter(const RecordWriter &) = delete;
+        RecordWriter &operator=(const RecordWriter &) = delete;
+
+        // Ouvre le fichier en ajout. Écrit l'en-tête si le fichier est vide.
+        bool open(const char *path)
+        {
+            close();
+            file = std::fopen(path, "ab");
+            if (!file)
+                return false;
+            std::fseek(file, 0, SEEK_END);
+            if (std::ftell(file) == 0)
+                std::fwrite(MAGIC, 1, HEADER_SIZE, file);
+            used = 0;
+            return true;
+        }
+
+        bool is_open() const { return file != nullptr; }
+
+        inline void push(const PositionRecord &rec)
+        {
+            if (used + MAX_RECORD_SIZE > BUFFER_SIZE)
+                flush();
+            used += encode(rec, buffer.data() + used);
+        }
+
+        void flush()
+        {
+            if (file && used > 0)
+            {
+                std::fwrite(buffer.data(), 1, used, file);
+                std::fflush(file);
+            }
+            used = 0;
+        }
+
+        void close()
+        {
+            if (!file)
+                return;
+            flush();
+            std::fclose(file);
+            file = nullptr;
+        }
+
+    private:
+        std::FILE *file = nullptr;
+        std::vector<uint8_t> buffer;
+        size_t used = 0;
+    };
+
+    // --- LECTURE ---
+    // Vue sur un record dans le fichier projeté en mémoire (aucune copie)
+    struct RecordView
+    {
+        const uint8_t *data = nullptr;
+
+        inline int size() const { return data[0]; }
+        inline uint8_t side_to_move() const { return (data[1] & 1) ? 2 : 1; }
+        inline GameResult result() const { return static_cast<GameResult>((data[1] >> 1) & 3); }
+        inline bool is_game_end() const { return (data[1] & 16) != 0; }
+        inline bool decode(PositionRecord &rec) const { return Records::decode(data, rec); }
+    };
+
+    // Lecteur par projection mémoire (mmap / MapViewOfFile) : les records sont parcourus
+    // directement dans les pages du fichier, le noyau se charge de la lecture anticipée.
+    class RecordReader
+    {
+    public:
+        RecordReader() = default;
+        ~RecordReader() { close(); }
+
+        RecordReader(const RecordReader &) = delete;
+        RecordReader &operator=(const RecordReader &) = delete;
+
+        bool open(const char *path)
+        {
+            close();
+#ifdef _WIN32
+            file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER file_size;
+            GetFileSizeEx(file, &file_size);
+            size = static_cast<size_t>(file_size.QuadPart);
+            if (size >= HEADER_SIZE)
+            {
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping)
+                    base = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+#else
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size >= HEADER_SIZE)
+            {
+                size = static_cast<size_t>(st.st_size);
+                void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr != MAP_FAILED)
+                {
+                    base = static_cast<const uint8_t *>(addr);
+                    madvise(addr, size, MADV_SEQUENTIAL);
+                }
+            }
+            ::close(fd);
+#endif
+            if (!base || std::memcmp(base, MAGIC, HEADER_SIZE) != 0)
+            {
+                close();
+                return false;
+            }
+            cursor = base + HEADER_SIZE;
+            return true;
+        }
+
+        // Avance au record suivant. Retourne false à la fin du fichier (ou sur un record tronqué).
+        inline bool next(RecordView &view)
+        {
+            const uint8_t *end = base + size;
+            if (cursor >= end || cursor[0] < 2 || cursor + cursor[0] > end)
+                return false;
+            view.data = cursor;
+            cursor += cursor[0];
+            return true;
+        }
+
+        // Revient au premier record
+        void rewind() { cursor = base ? base + HEADER_SIZE : nullptr; }
+
+        void close()
+        {
+#ifdef _WIN32
+            if (base)
+                UnmapViewOfFile(base);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (base)
+                munmap(const_cast<uint8_t *>(base), size);
+#endif
+            base = nullptr;
+            cursor = nullptr;
+            size = 0;
+        }
+
+    private:
+        const uint8_t *base = nullptr;
+        const uint8_t *cursor = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+    };
+};
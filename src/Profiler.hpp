@@ -0,0 +1,135 @@
+#pragma once
+
+// Profileur intégré des fonctions chaudes (règles, évaluation, table de transposition, tri).
+// Compilé seulement avec -DAI_PROFILE : sinon les macros sont vides et n'ont aucun coût.
+//
+//   PROFILE_ZONE(APPLY_MOVE);  // mesure le bloc courant (rdtsc à l'entrée et à la sortie)
+//   PROFILE_SESSION();         // la session la plus externe remet les compteurs à zéro,
+//                              // puis affiche le rapport sur std::cerr à sa destruction
+//
+// Les compteurs sont par thread (thread_local) : aucune synchronisation dans les zones.
+
+#ifdef AI_PROFILE
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace Profiler
+{
+    enum Zone : int
+    {
+        GENERATE_MOVES,
+        APPLY_MOVE,
+        EVALUATE,
+        ZOBRIST,
+        TT_PROBE,
+        TT_STORE,
+        MOVE_ORDERING,
+        NB_ZONES
+    };
+
+    static const char *ZONE_NAMES[NB_ZONES] = {
+        "generate_moves",
+        "apply_move",
+        "evaluate",
+        "Zobrist::compute",
+        "TT probe",
+        "TT store",
+        "move ordering (sort)",
+    };
+
+    // Compteur de cycles (rdtsc), ou nanosecondes sur les autres architectures
+    inline uint64_t ticks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    struct Counters
+    {
+        uint64_t cycles[NB_ZONES] = {};
+        uint64_t calls[NB_ZONES] = {};
+        uint64_t session_start = 0;
+        int session_depth = 0;
+    };
+
+    static thread_local Counters counters;
+
+    struct ScopedZone
+    {
+        Zone zone;
+        uint64_t start;
+
+        explicit ScopedZone(Zone z) : zone(z), start(ticks()) {}
+        ~ScopedZone()
+        {
+            counters.cycles[zone] += ticks() - start;
+            counters.calls[zone]++;
+        }
+    };
+
+    // Rapport : cycles par appel et part du temps total de la session, par fonction
+    inline void report(std::ostream &out)
+    {
+        uint64_t total = ticks() - counters.session_start;
+        uint64_t in_zones = 0;
+        char line[160];
+
+        out << "---------------------------------------------------------------------------" << std::endl;
+        std::snprintf(line, sizeof(line), "%-22s %14s %16s %12s %8s", "zone", "calls", "cycles", "cycles/call", "share");
+        out << line << std::endl;
+        for (int z = 0; z < NB_ZONES; ++z)
+        {
+            in_zones += counters.cycles[z];
+            std::snprintf(line, sizeof(line), "%-22s %14llu %16llu %12.1f %7.2f%%", ZONE_NAMES[z],
+                          (unsigned long long)counters.calls[z], (unsigned long long)counters.cycles[z],
+                          counters.calls[z] ? (double)counters.cycles[z] / counters.calls[z] : 0.0,
+                          total ? 100.0 * counters.cycles[z] / total : 0.0);
+            out << line << std::endl;
+        }
+        uint64_t rest = total > in_zones ? total - in_zones : 0;
+        std::snprintf(line, sizeof(line), "%-22s %14s %16llu %12s %7.2f%%", "(search, other)", "",
+                      (unsigned long long)rest, "", total ? 100.0 * rest / total : 0.0);
+        out << line << std::endl;
+        std::snprintf(line, sizeof(line), "%-22s %14s %16llu", "total", "", (unsigned long long)total);
+        out << line << std::endl;
+        out << "---------------------------------------------------------------------------" << std::endl;
+    }
+
+    struct Session
+    {
+        Session()
+        {
+            if (counters.session_depth++ == 0)
+            {
+                for (int z = 0; z < NB_ZONES; ++z)
+                    counters.cycles[z] = counters.calls[z] = 0;
+                counters.session_start = ticks();
+            }
+        }
+        ~Session()
+        {
+            if (--counters.session_depth == 0)
+                report(std::cerr);
+        }
+    };
+};
+
+#define PROFILE_ZONE(zone) Profiler::ScopedZone profile_zone(Profiler::zone)
+#define PROFILE_SESSION() Profiler::Session profile_session
+
+#else
+
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_SESSION() ((void)0)
+
+#endif
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "GameState.hpp"
+#include "GameRules.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "Search.hpp"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Mode moteur : protocole étendu à côté du protocole Arbitre (START / coups / RESULT).
+// Activé en envoyant "protocol" comme première ligne. Commandes :
+//   isready                                   -> readyok
+//   newgame                                   vide la table de transposition
+//   position startpos|board <pos> [moves ...] position courante (cf. Notation::board_to_string)
+//   go [depth N] [nodes N] [movetime MS] [infinite]
+//                                             lance la recherche -> info ... / bestmove <coup>
+//   stop                                      arrête la recherche en cours
+//   bench [profondeur]                        recherche la suite de positions de référence
+//   quit
+namespace Protocol
+{
+    constexpr int BENCH_DEPTH = 8; // Profondeur par défaut du bench
+
+    // Suite de référence du bench : coups joués depuis la position de départ
+    static const char *BENCH_POSITIONS[] = {
+        "",
+        "1B 4TR 3B",
+        "13R 8B 1TR 10R 3TB 2R",
+        "9TB 16TB 1B 10TR 5TB 12TB 5B 10B 15TR 2R",
+        "13B 4TB 1B 16TB 7R 10TB 1TB 2R 13TR 8B 9TB 14TB 15TB 10B 5TR 2TR",
+        "5B 12R 15TR 14R 11R 10R 11TB 8TB 9TR 16TR 9B 12TB 7R 2TR 13TB 6TR 7B 14TB 1B 10B 11TB 12TR 1B 16B",
+        "1TR 2TB 1B 2B 11TB 16TB 9B 12R 5R 14TB 15TB 6R 15R 4B 3B 10R 9TR 8R 11TB 14R 9B 10TR 7B 4TR 15R 6TB 9R 10B 7TR 4B 3TB 12TB 1TB 8R",
+        "7TR 6TB 3R 12R 11TR 8B 7TB 16TR 13B 6R 1B 4TB 5R 2B 7B 8R 7TR 4R 15TB 14TB 11R 14R 13R 12TR 9B 8R 13B 10TB 9TR 8TB 15B 2TR 11TB 16B 1TB 8TB 5R 16TB 1R 4TB 13TR 10TB 9TB 16TB 5TB 14TB 15TB 2TR",
+    };
+
+    static std::mutex output_mutex; // Les lignes "info" viennent du thread de recherche
+
+    inline void send(std::ostream &out, const std::string &line)
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        out << line << std::endl;
+    }
+
+    // Recherche chaque position de la suite à profondeur fixe, tables vidées entre deux positions.
+    // Le total de nœuds sert de signature : il ne change que si la recherche change.
+    inline uint64_t run_bench(int depth, std::ostream &out)
+    {
+        PROFILE_SESSION(); // Un seul rapport pour toute la suite (si AI_PROFILE)
+        AI::stop_requested = false; // Un "stop" précédent ne doit pas tronquer le bench
+        uint64_t total_nodes = 0;
+        auto bench_start = std::chrono::high_resolution_clock::now();
+        const int nb_positions = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+
+        for (int i = 0; i < nb_positions; ++i)
+        {
+            GameState state;
+            int side_to_move = 1;
+            std::istringstream position("startpos moves " + std::string(BENCH_POSITIONS[i]));
+            Notation::parse_position(position, state, side_to_move);
+
+            AI::SearchLimits bench_limits;
+            bench_limits.max_depth = depth;
+            AI::clear_tables();
+            Move best = AI::find_best_move(state, side_to_move, bench_limits);
+            total_nodes += AI::main_context.nodes_count;
+
+            out << "Position " << (i + 1) << "/" << nb_positions << " : bestmove " << Notation::move_to_string(best)
+                << " score " << AI::main_context.info.score << " nodes " << AI::main_context.nodes_count << std::endl;
+        }
+
+        double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - bench_start).count();
+        out << "===========================" << std::endl;
+        out << "Total time (ms) : " << static_cast<uint64_t>(elapsed_ms) << std::endl;
+        out << "Nodes searched  : " << total_nodes << std::endl;
+        out << "Nodes/second    : " << static_cast<uint64_t>(total_nodes * 1000.0 / std::max(elapsed_ms, 1.0)) << std::endl;
+        return total_nodes;
+    }
+
+    // Boucle du mode moteur. La recherche tourne dans un thread dédié pendant que ce thread
+    // continue de lire l'entrée standard, ce qui permet de traiter "stop" immédiatement.
+    inline void run(std::istream &in, std::ostream &out)
+    {
+        GameState state;
+        int side_to_move = 1;
+        std::thread search_thread;
+
+        // Toute commande qui touche à la position ou au moteur arrête d'abord la recherche en cours
+        // (arrêt implicite) : sinon, après "go infinite", ce thread attendrait indéfiniment et ne
+        // lirait jamais le "stop" suivant.
+        auto wait_search = [&]()
+        {
+            if (search_thread.joinable())
+            {
+                AI::stop_requested = true;
+                search_thread.join();
+            }
+        };
+
+        send(out, "protocolok");
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            std::istringstream tokens(line);
+            std::string command;
+            if (!(tokens >> command))
+                continue;
+
+            if (command == "isready")
+            {
+                send(out, "readyok");
+            }
+            else if (command == "stop")
+            {
+                wait_search();
+            }
+            else if (command == "quit")
+            {
+                AI::stop_requested = true;
+                break;
+            }
+            else if (command == "newgame")
+            {
+                wait_search();
+                AI::clear_tables();
+                state = GameState();
+                side_to_move = 1;
+            }
+            else if (command == "position")
+            {
+                wait_search();
+                GameState parsed;
+                int parsed_side = 1;
+                if (Notation::parse_position(tokens, parsed, parsed_side))
+                {
+                    state = parsed;
+                    side_to_move = parsed_side;
+                }
+                else
+                    send(out, "info string invalid position");
+            }
+            else if (command == "go")
+            {
+                wait_search();
+                AI::SearchLimits go_limits;
+                bool infinite = false;
+                std::string key;
+                while (tokens >> key)
+                {
+                    if (key == "depth")
+                        tokens >> go_limits.max_depth;
+                    else if (key == "nodes")
+                        tokens >> go_limits.max_nodes;
+                    else if (key == "movetime")
+                        tokens >> go_limits.time_limit_ms;
+                    else if (key == "infinite")
+                        infinite = true;
+                }
+                // Sans limite explicite : même budget qu'en match (2s, 50ms de marge)
+                if (!infinite && go_limits.max_depth == AI::MAX_DEPTH && go_limits.max_nodes == 0 && go_limits.time_limit_ms <= 0)
+                    go_limits.time_limit_ms = 2000.0 - 50.0;
+
+                go_limits.on_iteration = [&out](const AI::SearchInfo &info)
+                {
+                    uint64_t nps = static_cast<uint64_t>(info.nodes * 1000.0 / std::max(info.time_ms, 1.0));
+                    send(out, "info depth " + std::to_string(info.depth) + " score " + std::to_string(info.score) +
+                                  " nodes " + std::to_string(info.nodes) + " time " + std::to_string(static_cast<uint64_t>(info.time_ms)) +
+                                  " nps " + std::to_string(nps) + " pv " + Notation::pv_to_string(info.pv));
+                };
+
+                AI::stop_requested = false;
+                GameState root = state;
+                int root_side = side_to_move;
+                search_thread = std::thread([&out, root, root_side, go_limits]()
+                                            {
+                                                Move best = AI::find_best_move(root, root_side, go_limits);
+                                                send(out, "bestmove " + (best.hole < NB_HOLES ? Notation::move_to_string(best) : std::string("none")));
+                                            });
+            }
+            else if (command == "bench")
+            {
+                wait_search();
+                int depth = BENCH_DEPTH;
+                if (!(tokens >> depth))
+                    depth = BENCH_DEPTH;
+                std::lock_guard<std::mutex> lock(output_mutex);
+                run_bench(depth, out);
+            }
+            else if (command == "d")
+            {
+                wait_search();
+                send(out, Notation::board_to_string(state, side_to_move));
+            }
+            else
+            {
+                send(out, "info string unknown command " + command);
+            }
+        }
+
+        wait_search();
+    }
+};
@@ -3,27 +3,42 @@
 #include "GameRules.hpp"
 #include "GameState.hpp"
 #include "Move.hpp"
+#include "Profiler.hpp"
 #include <vector>
 #include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <cstdint>
-#include <random>
+#include <cstdlib>
 #include <array>
+#include <atomic>
+#include <functional>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 namespace AI
 {
 
     // --- CONFIGURATION ---
-    static std::chrono::time_point<std::chrono::high_resolution_clock> start_time; // Temps de début de la recherche
-    static double time_limit_ms;                                                   // Limite de temps en millisecondes
-    static bool time_out;                                                          // Indicateur de dépassement de temps
-
-    static int nodes_count = 0; // Compteur de nœuds explorés
-
     constexpr int INF = 10000000; // Valeur infinie pour l'alpha-beta
     constexpr int MAX_DEPTH = 64; // Profondeur maximale de recherche
 
+    // Scores de fin de partie : une victoire obtenue n demi-coups après la racine vaut WIN_SCORE - n
+    // (une défaite -WIN_SCORE + n), pour préférer les victoires rapides et les défaites lentes.
+    constexpr int WIN_SCORE = INF - 1000;       // Au-dessus de toute évaluation heuristique
+    constexpr int WIN_BOUND = WIN_SCORE - 1000; // |score| >= WIN_BOUND : résultat forcé
+    constexpr int DRAW_SCORE = 0;               // Égalité (48 - 48 ou scores finaux égaux)
+
+    inline bool is_decided(int score) { return score >= WIN_BOUND || score <= -WIN_BOUND; }
+
     // --- STRUCTURE DE DONNÉES LÉGÈRE POUR LES LISTES DE COUPS ---
     template <typename T, int Capacity>
     struct StaticVector
@@ -41,6 +56,28 @@ namespace AI
         inline const T &operator[](int i) const { return data[i]; }    // Accès par index (const)
     };
 
+    // Informations sur une itération terminée de l'approfondissement itératif
+    struct SearchInfo
+    {
+        int depth = 0;        // Profondeur terminée
+        int score = 0;        // Score (point de vue du joueur au trait, cf. WIN_SCORE)
+        uint64_t nodes = 0;   // Nœuds explorés depuis le début de la recherche
+        double time_ms = 0;   // Temps écoulé
+        Move best_move;       // Meilleur coup à cette profondeur
+        StaticVector<Move, MAX_DEPTH> pv; // Variation principale (lue dans la table de transposition)
+    };
+
+    // Limites d'une recherche : la première atteinte arrête la recherche
+    struct SearchLimits
+    {
+        int max_depth = MAX_DEPTH;                           // Profondeur maximale
+        uint64_t max_nodes = 0;                              // Nombre de nœuds maximal (0 = illimité)
+        double time_limit_ms = 0;                            // Temps maximal en millisecondes (0 = illimité)
+        std::function<void(const SearchInfo &)> on_iteration; // Appelé à chaque profondeur terminée
+    };
+
+    static std::atomic<bool> stop_requested{false}; // Arrêt demandé depuis un autre thread (commande stop)
+
     // --- DONNÉES POUR L'IA ---
     struct BotDNA
     {
@@ -60,29 +97,58 @@ namespace AI
 
     // --- 1. ZOBRIST HASHING ---
     // Permet de générer un hash unique pour chaque état du jeu
+    // Les clés sont générées à la compilation (splitmix64) : aucun coût au démarrage du processus
+    //
+    // Pas de canonicalisation par la symétrie joueur 1 / joueur 2 (rotation d'un trou) : les scores
+    // stockés sont du point de vue du joueur maximisant et evaluate() n'est pas antisymétrique
+    // (défense/attaque, thésaurisation, famine, w_holes comptés pour ses propres trous seulement).
+    // Une position et sa tournée n'ont donc pas la même valeur dans une recherche, et ne peuvent
+    // pas partager une entrée sans rendre l'évaluation symétrique (et la ré-optimiser).
     namespace Zobrist
     {
-        static uint64_t table[NB_HOLES][3][64];
-        static uint64_t turn_hash[2];
-        static bool initialized = false;
+        constexpr int MAX_HASHED_SCORE = 127;
 
-        inline void init()
+        struct Keys
         {
-            if (initialized)
-                return;
-            std::mt19937_64 rng(12345);
+            uint64_t table[NB_HOLES][3][64];
+            uint64_t turn_hash[2];
+            uint64_t score_hash[2][MAX_HASHED_SCORE + 1]; // Scores des joueurs 1 et 2
+        };
+
+        constexpr uint64_t splitmix64(uint64_t &state)
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        constexpr Keys generate_keys()
+        {
+            Keys keys{};
+            uint64_t state = 12345;
             for (int i = 0; i < NB_HOLES; ++i)
                 for (int c = 0; c < 3; ++c)
                     for (int n = 0; n < 64; ++n)
-                        table[i][c][n] = rng();
-            turn_hash[0] = rng();
-            turn_hash[1] = rng();
-            initialized = true;
+                        keys.table[i][c][n] = splitmix64(state);
+            keys.turn_hash[0] = splitmix64(state);
+            keys.turn_hash[1] = splitmix64(state);
+            for (int p = 0; p < 2; ++p)
+                for (int n = 0; n <= MAX_HASHED_SCORE; ++n)
+                    keys.score_hash[p][n] = splitmix64(state);
+            return keys;
         }
 
-        // Calcule le hash Zobrist pour un état de jeu donné
+        static constexpr Keys keys = generate_keys();
+        static constexpr auto &table = keys.table;
+        static constexpr auto &turn_hash = keys.turn_hash;
+        static constexpr auto &score_hash = keys.score_hash;
+
+        // Calcule le hash Zobrist pour un état de jeu donné. Les scores en font partie : un même
+        // plateau avec une autre répartition des graines capturées n'a pas la même valeur.
         inline uint64_t compute(const GameState &state, int player_id)
         {
+            PROFILE_ZONE(ZOBRIST);
             uint64_t h = 0;
             for (int i = 0; i < NB_HOLES; ++i)
             {
@@ -96,6 +162,8 @@ namespace AI
                 if (t > 0)
                     h ^= table[i][2][t];
             }
+            h ^= score_hash[0][std::min((int)state.score_p1, MAX_HASHED_SCORE)];
+            h ^= score_hash[1][std::min((int)state.score_p2, MAX_HASHED_SCORE)];
             h ^= turn_hash[player_id - 1];
             return h;
         }
@@ -109,31 +177,105 @@ namespace AI
         LOWERBOUND,
         UPPERBOUND
     };
+    // Une entrée n'est valide que si sa génération est la génération courante : une entrée
+    // à zéro (page jamais touchée) ou d'une partie précédente est traitée comme vide.
     struct TTEntry
     {
         uint64_t key = 0;
         int score = 0;
         int depth = 0;
         TTFlag flag = TTFlag::EXACT;
+        uint8_t generation = 0;
         Move best_move;
     };
 
-    constexpr size_t TT_SIZE = 1048576;                       // Valeur de la table de transposition (2^20)
-    constexpr size_t TT_MASK = TT_SIZE - 1;                   // Masque pour l'indexation
-    static std::vector<TTEntry> transposition_table(TT_SIZE); // Table de transposition
+    // Dans la table, un score de victoire est stocké relativement au nœud (distance depuis ce nœud)
+    // et non à la racine : il reste juste si la position est retrouvée à un autre ply.
+    inline int score_to_tt(int score, int ply)
+    {
+        if (score >= WIN_BOUND)
+            return score + ply;
+        if (score <= -WIN_BOUND)
+            return score - ply;
+        return score;
+    }
+    inline int score_from_tt(int score, int ply)
+    {
+        if (score >= WIN_BOUND)
+            return score - ply;
+        if (score <= -WIN_BOUND)
+            return score + ply;
+        return score;
+    }
+
+    constexpr size_t TT_SIZE = 1048576;  // Valeur de la table de transposition (2^20)
+    constexpr size_t TT_MIN_SIZE = 4096; // Taille minimale si la mémoire manque (2^12)
+
+    // Alloue la table en pages anonymes : le système les fournit à zéro et ne les engage
+    // qu'au premier accès, donc ni construction ni remplissage des 2^20 entrées.
+    // Avec AI_TT_HUGEPAGES, on demande des pages de 2 Mo (moins de défauts de TLB).
+    // Retourne nullptr si l'allocation échoue.
+    inline TTEntry *allocate_tt(size_t nb_entries)
+    {
+        const size_t bytes = nb_entries * sizeof(TTEntry);
+#ifdef _WIN32
+        return static_cast<TTEntry *>(VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+        void *mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+            return nullptr;
+#if defined(AI_TT_HUGEPAGES) && defined(MADV_HUGEPAGE)
+        madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<TTEntry *>(mem);
+#endif
+    }
+
+    inline void release_tt(TTEntry *table, size_t nb_entries)
+    {
+        if (!table)
+            return;
+#ifdef _WIN32
+        (void)nb_entries;
+        VirtualFree(table, 0, MEM_RELEASE);
+#else
+        munmap(table, nb_entries * sizeof(TTEntry));
+#endif
+    }
+
+    // --- 3. ÉTAT D'UNE RECHERCHE ---
+    // Tout ce que la recherche modifie : une instance par moteur indépendant (par exemple un par
+    // thread pour l'analyse en parallèle). Le mode match et le protocole utilisent main_context.
+    struct SearchContext
+    {
+        std::chrono::time_point<std::chrono::high_resolution_clock> start_time; // Temps de début de la recherche
+        double time_limit_ms = 0; // Limite de temps en millisecondes
+        bool time_out = false;    // Indicateur de dépassement de temps
+        uint64_t nodes_count = 0; // Compteur de nœuds explorés
+        SearchLimits limits;      // Limites de la recherche en cours
+        SearchInfo info;          // Dernière itération terminée
+
+        TTEntry *transposition_table = nullptr; // Table de transposition, allouée au premier usage
+        size_t tt_mask = 0;                     // Masque d'indexation (taille de la table - 1)
+        uint8_t tt_generation = 1;              // Génération courante (jamais 0)
+
+        // Heuristiques de tri
+        Move killer_moves[MAX_DEPTH + 1][2]; // Deux coups tueurs par profondeur
+        int history_table[NB_HOLES][4] = {}; // Table d'historique des coups
+
+        SearchContext() = default;
+        ~SearchContext() { release_tt(transposition_table, tt_mask + 1); }
+        SearchContext(const SearchContext &) = delete;
+        SearchContext &operator=(const SearchContext &) = delete;
+    };
 
-    // --- 3. HEURISTIQUES DE TRI ---
-    static Move killer_moves[MAX_DEPTH + 1][2]; // Deux coups tueurs par profondeur
-    static int history_table[NB_HOLES][4];  // Table d'historique des coups
+    static SearchContext main_context; // Moteur du mode match et du protocole
 
     // --- 4. EVALUATION ---
+    // Évaluation heuristique d'une position non terminale (les fins de partie sont notées par terminal_score)
     inline int evaluate(const GameState &state, int maximizing_player_id)
     {
-        if (state.score_p1 >= 49)
-            return (maximizing_player_id == 1) ? INF : -INF; // Victoire joueur 1
-        if (state.score_p2 >= 49)
-            return (maximizing_player_id == 2) ? INF : -INF; // Victoire joueur 2
-
+        PROFILE_ZONE(EVALUATE);
         int score_diff = (maximizing_player_id == 1) ? (state.score_p1 - state.score_p2) : (state.score_p2 - state.score_p1); // Différence de score
         int eval = score_diff * ia_dna.w_score;                                                                               // Poids du score
 
@@ -184,22 +326,68 @@ namespace AI
         return eval;
     }
 
+    // Score exact d'une partie terminée, ply demi-coups après la racine. Les graines restantes ne
+    // comptent pas (moins de 10 graines, 400 coups), sauf en cas de famine : si starved_player_id
+    // ne peut pas jouer, son adversaire les ramasse toutes (règle de l'Arbitre).
+    inline int terminal_score(const GameState &state, int starved_player_id, int maximizing_player_id, int ply)
+    {
+        int final_p1 = state.score_p1;
+        int final_p2 = state.score_p2;
+        if (starved_player_id == 1)
+            final_p2 += state.count_all_seeds();
+        else if (starved_player_id == 2)
+            final_p1 += state.count_all_seeds();
+
+        int my_final = (maximizing_player_id == 1) ? final_p1 : final_p2;
+        int opp_final = (maximizing_player_id == 1) ? final_p2 : final_p1;
+        if (my_final > opp_final)
+            return WIN_SCORE - ply;
+        if (my_final < opp_final)
+            return -WIN_SCORE + ply;
+        return DRAW_SCORE;
+    }
+
+    // Encadrement du score atteignable depuis une position non terminale. Une partie se joue
+    // au plus tôt au demi-coup suivant ; un joueur qui ne peut plus dépasser l'autre même en
+    // ramassant toutes les graines restantes ne peut plus gagner (par exemple l'adversaire a 48 :
+    // les 96 graines étant réparties, on finit au plus à 48).
+    struct OutcomeBounds
+    {
+        int lower;
+        int upper;
+    };
+
+    inline OutcomeBounds outcome_bounds(const GameState &state, int maximizing_player_id, int ply)
+    {
+        int my_score = (maximizing_player_id == 1) ? state.score_p1 : state.score_p2;
+        int opp_score = (maximizing_player_id == 1) ? state.score_p2 : state.score_p1;
+        int remaining = state.count_all_seeds();
+
+        OutcomeBounds bounds{-WIN_SCORE + ply + 1, WIN_SCORE - ply - 1};
+        if (my_score + remaining <= opp_score)
+            bounds.upper = DRAW_SCORE; // Victoire impossible
+        if (opp_score + remaining <= my_score)
+            bounds.lower = DRAW_SCORE; // Défaite impossible
+        return bounds;
+    }
+
     // --- 5. LOGIQUE DE TRI ---
-    inline int score_move(const GameState &state, const Move &move, int depth, const Move &tt_move)
+    inline int score_move(const SearchContext &ctx, const GameState &state, const Move &move, int depth, const Move &tt_move)
     {
         if (move.hole == tt_move.hole && move.type == tt_move.type)
             return 2000000; // Meilleur
-        if (move.hole == killer_moves[depth][0].hole && move.type == killer_moves[depth][0].type)
+        if (move.hole == ctx.killer_moves[depth][0].hole && move.type == ctx.killer_moves[depth][0].type)
             return 1000000; // Premier coup tueur
-        if (move.hole == killer_moves[depth][1].hole && move.type == killer_moves[depth][1].type)
+        if (move.hole == ctx.killer_moves[depth][1].hole && move.type == ctx.killer_moves[depth][1].type)
             return 900000; // Second coup tueur
 
-        return history_table[move.hole][(int)move.type];
+        return ctx.history_table[move.hole][(int)move.type];
     }
 
     // Génère tous les coups légaux pour le joueur courant
     inline StaticVector<Move, 70> generate_moves(const GameState &state, int player_id)
     {
+        PROFILE_ZONE(GENERATE_MOVES);
         StaticVector<Move, 70> moves;
         for (int i = 0; i < NB_HOLES; ++i)
         {
@@ -227,56 +415,78 @@ namespace AI
     }
 
     // --- 6. ALPHA-BETA PVS ---
-    int alpha_beta_pvs(GameState state, int depth, int alpha, int beta, int player_id, int maximizing_player_id)
+    // ply : distance à la racine, pour noter les fins de partie (victoire rapide préférée)
+    int alpha_beta_pvs(SearchContext &ctx, GameState state, int depth, int ply, int alpha, int beta, int player_id, int maximizing_player_id)
     {
-        nodes_count++;
+        ctx.nodes_count++;
 
-        // Vérification du temps écoulé toutes les 1024 itérations
-        if ((nodes_count & 1023) == 0)
+        // Vérification du temps écoulé, du nombre de nœuds et de l'arrêt toutes les 1024 itérations
+        if ((ctx.nodes_count & 1023) == 0)
         {
             auto now = std::chrono::high_resolution_clock::now();
             // Marge de sécurité augmentée à 50ms
-            if (std::chrono::duration<double, std::milli>(now - start_time).count() >= time_limit_ms)
+            if ((ctx.time_limit_ms > 0 && std::chrono::duration<double, std::milli>(now - ctx.start_time).count() >= ctx.time_limit_ms) ||
+                (ctx.limits.max_nodes > 0 && ctx.nodes_count >= ctx.limits.max_nodes) ||
+                stop_requested.load(std::memory_order_relaxed))
             {
-                time_out = true;
+                ctx.time_out = true;
                 return 0;
             }
         }
 
+        // Partie terminée : score exact, inutile de hacher ou d'évaluer
+        if (GameRules::is_game_over(state))
+            return terminal_score(state, 0, maximizing_player_id, ply);
+
+        // Famine : le joueur au trait ne peut pas jouer, la partie s'arrête (même sur une feuille).
+        // Avant les bornes : ce résultat, obtenu à ce ply, est hors de leur encadrement.
+        if (!GameRules::has_moves(state, player_id))
+            return terminal_score(state, player_id, maximizing_player_id, ply);
+
+        // Coupure par les bornes du résultat : une victoire plus rapide est déjà assurée ailleurs,
+        // le résultat ne peut plus sortir de la fenêtre, ou il est déjà fixé
+        OutcomeBounds bounds = outcome_bounds(state, maximizing_player_id, ply);
+        if (bounds.upper <= alpha)
+            return bounds.upper;
+        if (bounds.lower >= beta || bounds.lower == bounds.upper)
+            return bounds.lower;
+
         int alpha_orig = alpha;                               // Sauvegarde de la valeur originale d'alpha
         uint64_t hash = Zobrist::compute(state, player_id);   // Calcul du hash Zobrist
-        TTEntry &entry = transposition_table[hash & TT_MASK]; // Accès à l'entrée de la table de transposition
+        TTEntry &entry = ctx.transposition_table[hash & ctx.tt_mask]; // Accès à l'entrée de la table de transposition
         Move tt_move;                                         // Meilleur coup stocké dans la table de transposition
 
         // Vérification de l'entrée de la table de transposition
-        if (entry.key == hash)
         {
-            tt_move = entry.best_move;
-            if (entry.depth >= depth)
+            PROFILE_ZONE(TT_PROBE);
+            if (entry.key == hash && entry.generation == ctx.tt_generation)
             {
-                if (entry.flag == TTFlag::EXACT)
-                    return entry.score;
-                if (entry.flag == TTFlag::LOWERBOUND)
-                    alpha = std::max(alpha, entry.score);
-                else if (entry.flag == TTFlag::UPPERBOUND)
-                    beta = std::min(beta, entry.score);
-                if (alpha >= beta)
+                tt_move = entry.best_move;
+                if (entry.depth >= depth)
                 {
-                    return entry.score;
+                    int tt_score = score_from_tt(entry.score, ply);
+                    if (entry.flag == TTFlag::EXACT)
+                        return tt_score;
+                    if (entry.flag == TTFlag::LOWERBOUND)
+                        alpha = std::max(alpha, tt_score);
+                    else if (entry.flag == TTFlag::UPPERBOUND)
+                        beta = std::min(beta, tt_score);
+                    if (alpha >= beta)
+                    {
+                        return tt_score;
+                    }
                 }
             }
         }
 
-        // Condition de coup terminal ou profondeur maximale atteinte
-        if (depth == 0 || GameRules::is_game_over(state))
+        // Profondeur maximale atteinte : heuristique, ramenée dans les bornes du résultat
+        if (depth == 0)
         {
-            return evaluate(state, maximizing_player_id);
+            return std::clamp(evaluate(state, maximizing_player_id), bounds.lower, bounds.upper);
         }
 
         // Génération et tri des coups
         StaticVector<Move, 70> moves = generate_moves(state, player_id);
-        if (moves.empty())
-            return evaluate(state, maximizing_player_id);
 
         // Structure pour le tri des coups
         struct ScoredMove
@@ -288,11 +498,14 @@ namespace AI
 
         // Tri des coups selon leur score
         StaticVector<ScoredMove, 70> scored_moves;
-        for (int i = 0; i < moves.size(); ++i)
         {
-            scored_moves.push_back({moves[i], score_move(state, moves[i], depth, tt_move)});
+            PROFILE_ZONE(MOVE_ORDERING);
+            for (int i = 0; i < moves.size(); ++i)
+            {
+                scored_moves.push_back({moves[i], score_move(ctx, state, moves[i], depth, tt_move)});
+            }
+            std::sort(scored_moves.begin(), scored_moves.end(), std::greater<ScoredMove>());
         }
-        std::sort(scored_moves.begin(), scored_moves.end(), std::greater<ScoredMove>());
 
         // Initialisation du meilleur coup pour ce nœud
         Move best_move_this_node;
@@ -313,25 +526,25 @@ namespace AI
             int val;
             if (i == 0)
             {
-                val = alpha_beta_pvs(next_state, depth - 1, alpha, beta, next_player, maximizing_player_id);
+                val = alpha_beta_pvs(ctx, next_state, depth - 1, ply + 1, alpha, beta, next_player, maximizing_player_id);
             }
             else
             {
                 if (player_id == maximizing_player_id)
                 {
-                    val = alpha_beta_pvs(next_state, depth - 1, alpha, alpha + 1, next_player, maximizing_player_id);
+                    val = alpha_beta_pvs(ctx, next_state, depth - 1, ply + 1, alpha, alpha + 1, next_player, maximizing_player_id);
                     if (val > alpha && val < beta)
-                        val = alpha_beta_pvs(next_state, depth - 1, alpha, beta, next_player, maximizing_player_id);
+                        val = alpha_beta_pvs(ctx, next_state, depth - 1, ply + 1, alpha, beta, next_player, maximizing_player_id);
                 }
                 else
                 {
-                    val = alpha_beta_pvs(next_state, depth - 1, beta - 1, beta, next_player, maximizing_player_id);
+                    val = alpha_beta_pvs(ctx, next_state, depth - 1, ply + 1, beta - 1, beta, next_player, maximizing_player_id);
                     if (val < beta && val > alpha)
-                        val = alpha_beta_pvs(next_state, depth - 1, alpha, beta, next_player, maximizing_player_id);
+                        val = alpha_beta_pvs(ctx, next_state, depth - 1, ply + 1, alpha, beta, next_player, maximizing_player_id);
                 }
             }
 
-            if (time_out)
+            if (ctx.time_out)
                 return 0; // Arrêt si dépassement de temps
 
             // Mise à jour des bornes alpha/beta et du meilleur coup
@@ -357,22 +570,27 @@ namespace AI
             // Coup tueur et historique
             if (alpha >= beta)
             {
-                if (scored_moves[i].m.hole != killer_moves[depth][0].hole)
+                if (scored_moves[i].m.hole != ctx.killer_moves[depth][0].hole)
                 {
-                    killer_moves[depth][1] = killer_moves[depth][0];
-                    killer_moves[depth][0] = scored_moves[i].m;
+                    ctx.killer_moves[depth][1] = ctx.killer_moves[depth][0];
+                    ctx.killer_moves[depth][0] = scored_moves[i].m;
                 }
-                history_table[scored_moves[i].m.hole][(int)scored_moves[i].m.type] += depth * depth;
+                ctx.history_table[scored_moves[i].m.hole][(int)scored_moves[i].m.type] += depth * depth;
                 break;
             }
         }
 
         // Stockage dans la table de transposition
-        if (!time_out)
+        if (!ctx.time_out)
         {
+            PROFILE_ZONE(TT_STORE);
+            // Entrée d'une génération précédente : on ne garde pas son ancien coup
+            if (entry.generation != ctx.tt_generation)
+                entry.best_move = Move();
             entry.key = hash;
-            entry.score = best_val;
+            entry.score = score_to_tt(best_val, ply);
             entry.depth = depth;
+            entry.generation = ctx.tt_generation;
             if (best_move_this_node.hole < NB_HOLES)
             {
                 entry.best_move = best_move_this_node;
@@ -389,23 +607,83 @@ namespace AI
     }
 
     // --- 7. INTERFACE ---
-    inline Move find_best_move(const GameState &root_state, int player_id, double time_limit_sec)
+    // Vide la table de transposition (nouvelle partie, bench) : on change simplement de génération.
+    // Tous les 255 changements, on repart de pages neuves pour ne pas confondre deux générations.
+    inline void clear_tables(SearchContext &ctx)
     {
-        Zobrist::init(); // Initialisation du Zobrist hashing
+        if (++ctx.tt_generation == 0)
+        {
+            release_tt(ctx.transposition_table, ctx.tt_mask + 1);
+            ctx.transposition_table = nullptr;
+            ctx.tt_generation = 1;
+        }
+    }
+
+    // Alloue la table du contexte. Si la mémoire manque, on divise la taille par deux jusqu'à
+    // TT_MIN_SIZE : une petite table vaut mieux qu'un processus arrêté en pleine partie.
+    inline void reserve_tt(SearchContext &ctx)
+    {
+        for (size_t nb_entries = TT_SIZE; nb_entries >= TT_MIN_SIZE; nb_entries /= 2)
+        {
+            ctx.transposition_table = allocate_tt(nb_entries);
+            if (ctx.transposition_table)
+            {
+                ctx.tt_mask = nb_entries - 1;
+                if (nb_entries < TT_SIZE)
+                    std::cerr << "Table de transposition réduite à " << nb_entries << " entrées (mémoire insuffisante)" << std::endl;
+                return;
+            }
+        }
+        std::cerr << "Impossible d'allouer la table de transposition (" << TT_MIN_SIZE << " entrées)" << std::endl;
+        std::abort();
+    }
+
+    // Variation principale : on suit les meilleurs coups stockés dans la table de transposition
+    inline StaticVector<Move, MAX_DEPTH> principal_variation(const SearchContext &ctx, const GameState &root_state, int player_id, int max_length)
+    {
+        StaticVector<Move, MAX_DEPTH> pv;
+        GameState state = root_state;
+        int side = player_id;
+        while (pv.size() < std::min(max_length, MAX_DEPTH) && !GameRules::is_game_over(state))
+        {
+            uint64_t hash = Zobrist::compute(state, side);
+            const TTEntry &entry = ctx.transposition_table[hash & ctx.tt_mask];
+            if (entry.key != hash || entry.generation != ctx.tt_generation)
+                break;
+
+            // On vérifie que le coup est légal (collision de hash possible)
+            Move m = entry.best_move;
+            StaticVector<Move, 70> legal_moves = generate_moves(state, side);
+            if (std::find(legal_moves.begin(), legal_moves.end(), m) == legal_moves.end())
+                break;
+
+            pv.push_back(m);
+            GameRules::apply_move(state, m, side);
+            side = (side == 1) ? 2 : 1;
+        }
+        return pv;
+    }
+
+    inline Move find_best_move(SearchContext &ctx, const GameState &root_state, int player_id, const SearchLimits &search_limits)
+    {
+        PROFILE_SESSION(); // Rapport du profileur à la fin de la recherche (si AI_PROFILE)
         // Réinitialisation des structures de données de l'IA si c'est une nouvelle partie
         if (root_state.moves_count < 2)
         {
-            std::fill(transposition_table.begin(), transposition_table.end(), TTEntry());
+            clear_tables(ctx);
         }
+        if (!ctx.transposition_table)
+            reserve_tt(ctx);
         // Réinitialisation des compteurs et tables heuristiques
-        nodes_count = 0;
-        std::memset(history_table, 0, sizeof(history_table));
-        std::memset(killer_moves, 0, sizeof(killer_moves));
+        ctx.nodes_count = 0;
+        std::memset(ctx.history_table, 0, sizeof(ctx.history_table));
+        std::memset(ctx.killer_moves, 0, sizeof(ctx.killer_moves));
 
-        // Configuration du temps de recherche
-        start_time = std::chrono::high_resolution_clock::now();
-        time_limit_ms = (time_limit_sec * 1000.0) - 50.0;
-        time_out = false;
+        // Configuration des limites de recherche
+        ctx.limits = search_limits;
+        ctx.start_time = std::chrono::high_resolution_clock::now();
+        ctx.time_limit_ms = ctx.limits.time_limit_ms;
+        ctx.time_out = false;
 
         // Génération des coups initiaux
         StaticVector<Move, 70> moves = generate_moves(root_state, player_id);
@@ -414,24 +692,56 @@ namespace AI
 
         // Recherche itérative avec augmentation progressive de la profondeur
         Move best_move_found = moves[0];
+        ctx.info = SearchInfo();
 
         // Boucle de recherche itérative
-        for (int depth = 1; depth <= MAX_DEPTH; ++depth)
+        int max_depth = std::min(std::max(ctx.limits.max_depth, 1), MAX_DEPTH);
+        for (int depth = 1; depth <= max_depth; ++depth)
         {
-            alpha_beta_pvs(root_state, depth, -INF, INF, player_id, player_id);
-            if (time_out)
+            alpha_beta_pvs(ctx, root_state, depth, 0, -INF, INF, player_id, player_id);
+            if (ctx.time_out)
                 break;
 
             uint64_t root_hash = Zobrist::compute(root_state, player_id);
             // Optimisation bitwise
-            TTEntry &entry = transposition_table[root_hash & TT_MASK];
+            TTEntry &entry = ctx.transposition_table[root_hash & ctx.tt_mask];
 
-            if (entry.key == root_hash && entry.best_move.hole < NB_HOLES)
+            if (entry.key == root_hash && entry.generation == ctx.tt_generation && entry.best_move.hole < NB_HOLES)
             {
                 best_move_found = entry.best_move;
+                ctx.info.score = entry.score;
             }
+
+            ctx.info.depth = depth;
+            ctx.info.nodes = ctx.nodes_count;
+            ctx.info.time_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - ctx.start_time).count();
+            ctx.info.best_move = best_move_found;
+            ctx.info.pv = principal_variation(ctx, root_state, player_id, depth);
+            if (ctx.limits.on_iteration)
+                ctx.limits.on_iteration(ctx.info);
+
+            // Résultat prouvé (victoire ou défaite forcée, arbre complet jusqu'à la limite des
+            // 400 coups) : approfondir ne changerait plus rien
+            if (is_decided(ctx.info.score) || depth >= MAX_MOVES - root_state.moves_count)
+                break;
         }
 
         return best_move_found;
     }
+
+    // Raccourcis sur le moteur principal (mode match, protocole)
+    inline void clear_tables() { clear_tables(main_context); }
+
+    inline Move find_best_move(const GameState &root_state, int player_id, const SearchLimits &search_limits)
+    {
+        return find_best_move(main_context, root_state, player_id, search_limits);
+    }
+
+    // Recherche limitée par le temps (mode match), avec 50ms de marge de sécurité
+    inline Move find_best_move(const GameState &root_state, int player_id, double time_limit_sec)
+    {
+        SearchLimits match_limits;
+        match_limits.time_limit_ms = (time_limit_sec * 1000.0) - 50.0;
+        return find_best_move(main_context, root_state, player_id, match_limits);
+    }
 };
\ No newline at end of file